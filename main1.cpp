@@ -10,6 +10,8 @@
 #include <WiFiManager.h>        // captive-portal provisioning
 #include <ArduinoOTA.h>         // [OTA] wireless firmware update
 #include <PubSubClient.h>       // MQTT → ThingsBoard
+#include <HTTPClient.h>         // [PACK] packed uplink → bridge
+#include <WiFiClientSecure.h>
 
 // ── Persistence ──────────────────────────────────────────────
 #include <Preferences.h>        // [NVS] non-volatile credential store
@@ -37,6 +39,23 @@ namespace Config {
     constexpr int         TB_PORT         = 1883;
     constexpr const char* TB_TOKEN        = "VFIUsDTve9r5cBm8ZpPH"; 
 
+    // [PACK] Compact binary uplink — replaces the MQTT JSON publish with one
+    // HTTPS POST of a packed frame to the bridge (server.js /save-packed)
+    // every PACKED_MAX_SAMPLES samples. The bridge decodes it, forwards the
+    // samples to ThingsBoard's HTTP telemetry API and stores them in Mongo.
+    // Each POST pays a fresh TLS handshake (~270 B up) plus ~265 B of HTTP
+    // headers, so the batch must be large for the frame to be cheaper than
+    // JSON: 150 samples (5 min @ 2 s) ≈ 1.65 KB up vs 30 × 105 B MQTT
+    // PUBLISHes for one sample per 10 s. Dashboard lags by up to one batch.
+    constexpr bool        TELEMETRY_PACKED   = false;
+    constexpr const char* BRIDGE_PACKED_URL  = "https://rh-meter-bridge.onrender.com/save-packed";
+    constexpr uint8_t     PACKED_VERSION     = 1;
+    constexpr int         PACKED_MAX_SAMPLES = 150;   // 6 + 150*7 = 1056 B per POST
+    constexpr int32_t     BRIDGE_CONNECT_MS  = 2000;
+    constexpr uint16_t    BRIDGE_TIMEOUT_MS  = 3000;
+    constexpr uint32_t    BRIDGE_BACKOFF_MS  = 300000;      // retry ceiling after failures
+    constexpr time_t      MIN_VALID_EPOCH    = 1000000000;  // clock not NTP-synced below this
+
     // OTA
     constexpr const char* OTA_HOSTNAME    = "FactoryMonitor";
     constexpr const char* OTA_PASSWORD    = "ota_admin_2024";   // change in production
@@ -103,6 +122,8 @@ WebServer       webServer(80);
 Preferences     prefs;
 WiFiClient      wifiClient;
 PubSubClient    mqttClient(wifiClient);
+WiFiClientSecure bridgeTls;     // [PACK] one short-lived TLS session per batch
+HTTPClient      bridgeHttp;
 
 // ============================================================
 //  STATE
@@ -116,6 +137,8 @@ struct SensorReading {
 SensorReading   history[Config::MAX_READINGS];
 int             histIdx       = 0;
 int             histTotal     = 0;
+uint32_t        histSeq       = 0;   // monotonic count of pushed samples
+uint32_t        packedSeq     = 0;   // [PACK] histSeq at last successful packed publish
 
 float  currentTemp   = NAN;
 float  currentHum    = NAN;
@@ -125,6 +148,8 @@ float  lastHum       = NAN;
 bool   wifiOnline    = false;
 bool   mqttOnline    = false;
 bool   otaActive     = false;
+bool   bridgeOnline  = false;   // [PACK] last POST to the bridge succeeded
+bool   bridgeHalted  = false;   // [PACK] bridge rejected the frame/token (4xx)
 
 // Timers [NOB]
 uint32_t tLastSensor  = 0;
@@ -133,6 +158,8 @@ uint32_t tLastLCD     = 0;
 uint32_t tLastWiFiChk = 0;
 uint32_t tLastMqttChk = 0;
 uint32_t tLCDPage     = 0;
+uint32_t tBridgeRetry = 0;   // [PACK] last failed POST
+uint32_t bridgeBackoff = 0;   // [PACK] current retry delay (ms), 0 = none
 
 uint8_t  lcdPage      = 0;   // 0 = Temperature, 1 = Humidity
 
@@ -164,18 +191,24 @@ String nvsGet(const char* key, const char* fallback) {
 // ============================================================
 //  UTILITY
 // ============================================================
-String alertLevel(float v, float norm, float warn) {
-    if (v <= norm) return "normal";
-    if (v <= warn) return "warning";
-    return "critical";
+// Level codes: 0 = normal, 1 = warning, 2 = critical  ([PACK] wire values)
+const char* const LEVEL_NAMES[] = { "normal", "warning", "critical" };
+
+uint8_t alertLevelCode(float v, float norm, float warn) {
+    if (v <= norm) return 0;
+    if (v <= warn) return 1;
+    return 2;
 }
 
-String humLevel(float h) {
-    if (h < Config::HUM_DRY_LIMIT) return "critical";
-    if (h <= Config::HUM_WET_LIMIT) return "normal";
-    return "warning";
+uint8_t humLevelCode(float h) {
+    if (h < Config::HUM_DRY_LIMIT) return 2;
+    if (h <= Config::HUM_WET_LIMIT) return 0;
+    return 1;
 }
 
+String alertLevel(float v, float norm, float warn) { return LEVEL_NAMES[alertLevelCode(v, norm, warn)]; }
+String humLevel(float h)                           { return LEVEL_NAMES[humLevelCode(h)]; }
+
 String isoTime(time_t t) {
     struct tm ti; localtime_r(&t, &ti);
     char buf[20]; strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &ti);
@@ -196,6 +229,7 @@ void pushHistory(float t, float h) {
     history[histIdx] = { now, t, h };
     histIdx = (histIdx + 1) % Config::MAX_READINGS;
     if (histTotal < Config::MAX_READINGS) histTotal++;
+    histSeq++;
 }
 
 // ============================================================
@@ -220,7 +254,8 @@ void lcdStatusBar(uint8_t page) {
     lcd.setCursor(0, 0);
     if (wifiOnline) { lcd.write(CHR_WIFI); lcd.print(" Online "); }
     else            { lcd.print("X Offline"); }
-    lcd.print(mqttOnline ? " MQTT" : "     ");
+    if (Config::TELEMETRY_PACKED) lcd.print(bridgeOnline ? " BRDG" : "     ");
+    else                          lcd.print(mqttOnline   ? " MQTT" : "     ");
     if (otaActive)  lcd.print(" OTA");
     else { lcd.print("    "); lcd.setCursor(18, 0); lcd.print(page + 1); lcd.print("/2"); }
 }
@@ -398,6 +433,121 @@ void mqttPublish() {
     else    Serial.println("[MQTT] Publish failed");
 }
 
+// ============================================================
+//  PACKED TELEMETRY → BRIDGE  [PACK]
+// ============================================================
+/**
+ * Frame layout (all multi-byte fields little-endian):
+ *   [0]      version           (Config::PACKED_VERSION)
+ *   [1]      sample count N
+ *   [2..5]   base timestamp    uint32, epoch seconds of first sample
+ *   then N × 7-byte samples:
+ *   [0..1]   ts offset         uint16, seconds after base
+ *   [2..3]   temperature       int16,  °C  × 100
+ *   [4..5]   humidity          uint16, %RH × 100
+ *   [6]      levels            bits 0-1 temp, bits 2-3 hum
+ *                              (0 = normal, 1 = warning, 2 = critical)
+ *
+ * Sent as the body of an HTTPS POST (application/octet-stream) to
+ * Config::BRIDGE_PACKED_URL; the device token travels in X-Device-Token
+ * so the bridge can forward the samples to this ThingsBoard device.
+ * The MQTT session is not opened in this mode.
+ */
+constexpr size_t PACKED_HEADER_LEN = 6;
+constexpr size_t PACKED_SAMPLE_LEN = 7;
+
+static void putU16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+static void putU32(uint8_t* p, uint32_t v) { putU16(p, v & 0xFFFF); putU16(p + 2, v >> 16); }
+
+/**
+ * Once PACKED_MAX_SAMPLES are pending, sends the oldest of them in one frame.
+ * packedSeq advances only by what the bridge acknowledged, so a backlog
+ * left by an outage drains over the following cloud ticks. Samples stamped
+ * before NTP sync are skipped, and a frame ends early if the next offset
+ * would not fit in 16 bits.
+ *
+ * The POST blocks the loop for at most BRIDGE_CONNECT_MS + TLS handshake +
+ * BRIDGE_TIMEOUT_MS, once per batch. Failures back off exponentially up to
+ * BRIDGE_BACKOFF_MS; a 4xx (bad token/frame) stops uploads until reboot.
+ */
+void publishPacked() {
+    if (!wifiOnline || bridgeHalted) return;
+    if (bridgeBackoff && millis() - tBridgeRetry < bridgeBackoff) return;
+
+    time_t now; time(&now);
+    if (now < Config::MIN_VALID_EPOCH) return;   // wait for NTP
+
+    uint32_t pending = histSeq - packedSeq;
+    if (pending > (uint32_t)histTotal) {
+        Serial.printf("[PACK] %u samples overwritten before upload — dropped\n",
+                      (unsigned)(pending - histTotal));
+        packedSeq = histSeq - histTotal;
+        pending   = histTotal;
+    }
+
+    int      idx     = (histIdx - (int)pending + Config::MAX_READINGS) % Config::MAX_READINGS;
+    uint32_t skipped = 0;
+    while (pending > 0 && history[idx].ts < Config::MIN_VALID_EPOCH) {
+        idx = (idx + 1) % Config::MAX_READINGS;
+        pending--; skipped++;
+    }
+    if (skipped) {
+        packedSeq += skipped;
+        Serial.printf("[PACK] Skipped %u pre-NTP samples\n", (unsigned)skipped);
+    }
+    if (pending < (uint32_t)Config::PACKED_MAX_SAMPLES) return;   // batch not full yet
+
+    static uint8_t frame[PACKED_HEADER_LEN + PACKED_SAMPLE_LEN * Config::PACKED_MAX_SAMPLES];
+    time_t  base = history[idx].ts;
+    putU32(frame + 2, (uint32_t)base);
+
+    uint8_t* p = frame + PACKED_HEADER_LEN;
+    uint8_t  n = 0;
+    while (n < pending && n < Config::PACKED_MAX_SAMPLES) {
+        const SensorReading& r = history[(idx + n) % Config::MAX_READINGS];
+        if (r.ts < base || r.ts - base > 0xFFFF) break;   // next frame starts here
+        putU16(p,     (uint16_t)(r.ts - base));
+        putU16(p + 2, (uint16_t)(int16_t)lroundf(r.temp * 100.0f));
+        putU16(p + 4, (uint16_t)lroundf(r.hum * 100.0f));
+        p[6] = alertLevelCode(r.temp, Config::TEMP_NORMAL, Config::TEMP_WARNING)
+             | humLevelCode(r.hum) << 2;
+        p += PACKED_SAMPLE_LEN;
+        n++;
+    }
+    frame[0] = Config::PACKED_VERSION;
+    frame[1] = n;
+
+    size_t len   = p - frame;
+    String token = nvsGet("tb_token", Config::TB_TOKEN);   // [NVS]
+
+    bridgeHttp.begin(bridgeTls, Config::BRIDGE_PACKED_URL);
+    bridgeHttp.addHeader("Content-Type", "application/octet-stream");
+    bridgeHttp.addHeader("X-Device-Token", token);
+    int code = bridgeHttp.POST(frame, len);
+    bridgeHttp.end();
+
+    if (code == 200) {
+        packedSeq       += n;
+        bridgeOnline     = true;
+        bridgeBackoff    = 0;
+        Serial.printf("[PACK] Sent %u samples, %u B — %u still pending\n",
+                      (unsigned)n, (unsigned)len, (unsigned)(histSeq - packedSeq));
+        return;
+    }
+
+    bridgeOnline = false;
+    if (code >= 400 && code < 500) {
+        bridgeHalted = true;
+        Serial.printf("[PACK] Bridge rejected frame (%d) — uploads stopped, check token\n", code);
+        return;
+    }
+    tBridgeRetry  = millis();
+    bridgeBackoff = bridgeBackoff ? min(bridgeBackoff * 2, Config::BRIDGE_BACKOFF_MS)
+                                  : Config::CLOUD_INTERVAL_MS;
+    Serial.printf("[PACK] Bridge POST failed (%d) — retry in %u s\n",
+                  code, (unsigned)(bridgeBackoff / 1000));
+}
+
 /**
  * Called every MQTT_CHECK_MS.
  * Reconnects silently if broker is unreachable without stalling the loop.
@@ -513,7 +663,8 @@ void httpCurrent() {
     j += "\"tempLevel\":\"" + (isnan(currentTemp) ? "unknown" : alertLevel(currentTemp, Config::TEMP_NORMAL, Config::TEMP_WARNING)) + "\",";
     j += "\"humLevel\":\"" + (isnan(currentHum)  ? "unknown" : humLevel(currentHum)) + "\",";
     j += "\"wifi\":"     + String(wifiOnline ? "true" : "false") + ",";
-    j += "\"mqtt\":"     + String(mqttOnline ? "true" : "false");
+    j += "\"mqtt\":"     + String(mqttOnline ? "true" : "false") + ",";
+    j += "\"bridge\":"   + String(bridgeOnline ? "true" : "false");
     j += "}";
     webServer.sendHeader("Access-Control-Allow-Origin", "*");
     webServer.send(200, "application/json", j);
@@ -597,6 +748,14 @@ void setup() {
     mqttClient.setServer(Config::TB_HOST, Config::TB_PORT);
     mqttClient.setKeepAlive(60);
 
+    // [PACK] Bridge uplink — TLS without CA pinning; one connection per batch,
+    // with short timeouts so a cold bridge cannot stall the loop for long
+    bridgeTls.setInsecure();
+    bridgeTls.setHandshakeTimeout(Config::BRIDGE_TIMEOUT_MS / 1000);
+    bridgeHttp.setReuse(false);
+    bridgeHttp.setConnectTimeout(Config::BRIDGE_CONNECT_MS);
+    bridgeHttp.setTimeout(Config::BRIDGE_TIMEOUT_MS);
+
     // Web server routes
     webServer.on("/",            httpRoot);
     webServer.on("/api/current", httpCurrent);
@@ -640,7 +799,8 @@ void loop() {
     }
 
     // ── MQTT health check + keep-alive  [HEAL] ───────────────
-    if (now - tLastMqttChk >= Config::MQTT_CHECK_MS) {
+    // [PACK] Packed mode uploads via the bridge — no MQTT session at all
+    if (!Config::TELEMETRY_PACKED && now - tLastMqttChk >= Config::MQTT_CHECK_MS) {
         tLastMqttChk = now;
         mqttTask();
     }
@@ -654,7 +814,8 @@ void loop() {
     // ── Cloud publish every 10 s ─────────────────────────────
     if (now - tLastCloud >= Config::CLOUD_INTERVAL_MS) {
         tLastCloud = now;
-        mqttPublish();
+        if (Config::TELEMETRY_PACKED) publishPacked();
+        else                          mqttPublish();
     }
 
     // ── LCD update every 2 s ─────────────────────────────────
@@ -3,6 +3,7 @@ const mongoose   = require('mongoose');
 const bodyParser = require('body-parser');
 const cron       = require('node-cron');
 const axios      = require('axios');
+const { decodePacked, toThingsBoard } = require('./telemetry-codec');
 
 const app = express();
 app.use(bodyParser.json());
@@ -46,5 +47,52 @@ app.post('/save-data', async (req, res) => {
   }
 });
 
+// ── Save packed (binary) telemetry batch ────────────────────
+// Firmware with Config::TELEMETRY_PACKED POSTs raw frames here directly
+// (ThingsBoard's JSON MQTT transport cannot carry them). The samples are
+// forwarded to ThingsBoard's HTTP device API with their original ts, so
+// the dashboard keeps working, then stored in Mongo with the same ts.
+// Packed devices must be excluded from the rule chain that calls
+// /save-data, or Mongo gets each sample twice.
+const TB_HTTP_URL = process.env.TB_HTTP_URL || 'https://thingsboard.cloud';
+
+app.post('/save-packed', express.raw({ type: 'application/octet-stream', limit: '4kb' }), async (req, res) => {
+  if (!Buffer.isBuffer(req.body)) {
+    return res.status(415).send("Expected application/octet-stream");
+  }
+  let docs;
+  try {
+    docs = decodePacked(req.body);
+  } catch (err) {
+    console.error("❌ Packed Decode Error:", err.message);
+    return res.status(400).send("Bad frame");
+  }
+
+  // ThingsBoard first: telemetry is keyed by (key, ts), so a device retry
+  // after a later failure overwrites rather than duplicates.
+  // The device's own token is required: it is what authorises the write.
+  const token = req.get('X-Device-Token');
+  if (!token) return res.status(401).send("Missing device token");
+  try {
+    await axios.post(`${TB_HTTP_URL}/api/v1/${encodeURIComponent(token)}/telemetry`, toThingsBoard(docs));
+  } catch (err) {
+    console.error("❌ ThingsBoard Forward Error:", err.message);
+    // Pass 4xx (e.g. unknown token) through so the device stops retrying;
+    // anything else is transient.
+    const status = err.response && err.response.status;
+    if (status >= 400 && status < 500) return res.status(status).send("ThingsBoard rejected telemetry");
+    return res.status(502).send("ThingsBoard forward failed");
+  }
+
+  try {
+    await SensorData.insertMany(docs);
+    console.log(`💾 Saved packed: ${docs.length} samples`);
+    res.status(200).send("Saved");
+  } catch (err) {
+    console.error("❌ Save Error:", err);
+    res.status(500).send("Error");
+  }
+});
+
 const PORT = process.env.PORT || 3000;
 app.listen(PORT, () => console.log(`🚀 Bridge running on port ${PORT}`));
\ No newline at end of file
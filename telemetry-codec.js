@@ -0,0 +1,69 @@
+// ── Packed telemetry codec ──────────────────────────────────
+// Decodes the binary frames POSTed by the ESP32 when
+// Config::TELEMETRY_PACKED is enabled (see publishPacked() in
+// main1.cpp) back into the same JSON documents the firmware sends
+// in text mode and the SensorData schema in server.js stores.
+//
+// Frame (little-endian):
+//   u8  version   u8  count   u32 baseTs (epoch s)
+//   count × { u16 dt, i16 temp×100, u16 hum×100, u8 levels }
+
+const PACKED_VERSION    = 1;
+const HEADER_LEN        = 6;
+const SAMPLE_LEN        = 7;
+const LEVELS            = ['normal', 'warning', 'critical'];
+
+function levelName(code) {
+  return LEVELS[code] || 'unknown';
+}
+
+/**
+ * Decodes one packed frame into an array of
+ * { temperature, humidity, tempLevel, humLevel, timestamp }.
+ * Throws on unknown version or truncated input.
+ */
+function decodePacked(buf) {
+  if (!Buffer.isBuffer(buf) || buf.length < HEADER_LEN) {
+    throw new Error('packed frame too short');
+  }
+  const version = buf.readUInt8(0);
+  if (version !== PACKED_VERSION) {
+    throw new Error(`unsupported packed version ${version}`);
+  }
+  const count  = buf.readUInt8(1);
+  const baseTs = buf.readUInt32LE(2);
+  if (buf.length < HEADER_LEN + count * SAMPLE_LEN) {
+    throw new Error(`packed frame truncated: ${count} samples, ${buf.length} bytes`);
+  }
+
+  const samples = [];
+  for (let i = 0, off = HEADER_LEN; i < count; i++, off += SAMPLE_LEN) {
+    const levels = buf.readUInt8(off + 6);
+    samples.push({
+      temperature: buf.readInt16LE(off + 2) / 100,   // full 0.01 resolution
+      humidity:    buf.readUInt16LE(off + 4) / 100,
+      tempLevel:   levelName(levels & 0x03),
+      humLevel:    levelName((levels >> 2) & 0x03),
+      timestamp:   new Date((baseTs + buf.readUInt16LE(off)) * 1000)
+    });
+  }
+  return samples;
+}
+
+/**
+ * Maps decoded samples to the ThingsBoard telemetry upload format
+ * ([{ ts, values }]) used by the bridge to forward them to ThingsBoard.
+ */
+function toThingsBoard(samples) {
+  return samples.map(s => ({
+    ts: s.timestamp.getTime(),
+    values: {
+      temperature: s.temperature,
+      humidity:    s.humidity,
+      tempLevel:   s.tempLevel,
+      humLevel:    s.humLevel
+    }
+  }));
+}
+
+module.exports = { decodePacked, toThingsBoard, PACKED_VERSION };
@@ -0,0 +1,71 @@
+// Round-trip checks for telemetry-codec.js against frames built byte by
+// byte the way publishPacked() in main1.cpp lays them out.
+const test   = require('node:test');
+const assert = require('node:assert');
+const { decodePacked, toThingsBoard } = require('../telemetry-codec');
+
+// Mirrors putU16()/putU32() in the firmware (explicit little-endian).
+function putU16(out, v) { out.push(v & 0xFF, (v >> 8) & 0xFF); }
+function putU32(out, v) { putU16(out, v & 0xFFFF); putU16(out, (v >>> 16) & 0xFFFF); }
+
+function frame(base, samples, version = 1) {
+  const out = [version, samples.length];
+  putU32(out, base);
+  for (const s of samples) {
+    putU16(out, s.dt);
+    putU16(out, Math.round(s.temp * 100) & 0xFFFF);   // int16 two's complement
+    putU16(out, Math.round(s.hum * 100));
+    out.push(s.tLvl | (s.hLvl << 2));
+  }
+  return Buffer.from(out);
+}
+
+const BASE = 1760000000;
+
+test('decodes samples, timestamps and levels', () => {
+  const docs = decodePacked(frame(BASE, [
+    { dt: 0,     temp: 26.57, hum: 45.12, tLvl: 0, hLvl: 0 },
+    { dt: 2,     temp: -12.35, hum: 71.5, tLvl: 0, hLvl: 1 },
+    { dt: 65535, temp: 40.0,  hum: 12.0,  tLvl: 2, hLvl: 2 }
+  ]));
+  assert.deepStrictEqual(docs.map(d => [d.temperature, d.humidity, d.tempLevel, d.humLevel]), [
+    [26.57, 45.12, 'normal',  'normal'],
+    [-12.35, 71.5, 'normal',  'warning'],
+    [40,   12,   'critical', 'critical']
+  ]);
+  assert.deepStrictEqual(docs.map(d => d.timestamp.getTime() / 1000),
+                         [BASE, BASE + 2, BASE + 65535]);
+});
+
+// Half-way negatives must keep their full value rather than be re-rounded
+// (Math.round(-123.5) is -123, unlike the firmware's %.1f).
+test('keeps 0.01 resolution for negative half-way values', () => {
+  const [d] = decodePacked(frame(BASE, [{ dt: 0, temp: -0.05, hum: 0.05, tLvl: 0, hLvl: 2 }]));
+  assert.strictEqual(d.temperature, -0.05);
+  assert.strictEqual(d.humidity, 0.05);
+});
+
+test('maps to ThingsBoard ts/values', () => {
+  const tb = toThingsBoard(decodePacked(frame(BASE, [
+    { dt: 4, temp: 30.0, hum: 50.0, tLvl: 1, hLvl: 0 }
+  ])));
+  assert.deepStrictEqual(tb, [{
+    ts: (BASE + 4) * 1000,
+    values: { temperature: 30, humidity: 50, tempLevel: 'warning', humLevel: 'normal' }
+  }]);
+});
+
+test('accepts an empty batch', () => {
+  assert.deepStrictEqual(decodePacked(frame(BASE, [])), []);
+});
+
+test('rejects unknown version', () => {
+  assert.throws(() => decodePacked(frame(BASE, [], 2)), /unsupported packed version 2/);
+});
+
+test('rejects short and truncated frames', () => {
+  assert.throws(() => decodePacked(Buffer.from([1, 0, 0])), /too short/);
+  const f = frame(BASE, [{ dt: 0, temp: 20, hum: 50, tLvl: 0, hLvl: 0 }]);
+  assert.throws(() => decodePacked(f.subarray(0, f.length - 1)), /truncated/);
+  assert.throws(() => decodePacked('not a buffer'), /too short/);
+});